@@ -27,7 +27,8 @@ Application
     Test-checkIOspeed
 
 Description
-    Simple test of file writing, including timings
+    Simple test of file writing (and optionally reading), including timings.
+    Use -ascii to time the ASCII formatting/parsing of numbers.
 
 \*---------------------------------------------------------------------------*/
 
@@ -110,6 +111,12 @@ int main(int argc, char *argv[])
     );
 
     argList::addBoolOption("coherent", "Force coherent output");
+    argList::addBoolOption("ascii", "Write in ASCII format");
+    argList::addBoolOption
+    (
+        "read",
+        "Read back the fields after writing (without -mesh only)"
+    );
 
     #include "setRootCase.H"
     #include "createTime.H"
@@ -122,6 +129,14 @@ int main(int argc, char *argv[])
     const int verbose = args.verbose();
 
     const bool useCoherent = args.found("coherent");
+    const bool doRead = args.found("read");
+
+    const IOstreamOption::streamFormat fmt
+    (
+        args.found("ascii")
+      ? IOstreamOption::ASCII
+      : IOstreamOption::BINARY
+    );
 
     labelList excludes;
     args.readListIfPresent("exclude", excludes);
@@ -222,7 +237,7 @@ int main(int argc, char *argv[])
             }
         }
 
-        IOstreamOption streamOpt(IOstreamOption::BINARY);
+        IOstreamOption streamOpt(fmt);
 
         if (useCoherent)
         {
@@ -347,7 +362,7 @@ int main(int argc, char *argv[])
             }
         }
 
-        IOstreamOption streamOpt(IOstreamOption::BINARY);
+        IOstreamOption streamOpt(fmt);
 
         if (useCoherent)
         {
@@ -383,6 +398,38 @@ int main(int argc, char *argv[])
         Info<< nl << "Writing took "
             << timing.timeIncrement() << "s" << endl;
 
+        if (doRead && nProcsEff == UPstream::nProcs())
+        {
+            // Read back the last output
+            IOobject io
+            (
+                "field",
+                runTime.timeName(),
+                runTime,
+                IOobject::MUST_READ,
+                IOobject::NO_WRITE,
+                IOobject::NO_REGISTER
+            );
+
+            label nValues = 0;
+
+            for (label fieldi = 0; fieldi < nFields; ++fieldi)
+            {
+                io.resetHeader("field" + Foam::name(fieldi));
+
+                IOField<scalar> fld(io);
+                nValues += fld.size();
+            }
+
+            Info<< nl << "Reading " << nFields << " fields ("
+                << returnReduce(nValues, sumOp<label>()) << " values) took "
+                << timing.timeIncrement() << "s" << endl;
+        }
+        else if (doRead)
+        {
+            Info<< nl << "Warning: -read ignored with -exclude" << nl;
+        }
+
         Info<< nl
             << "Cleanup newly generated files with" << nl << nl
             << "    foamListTimes -rm -time "
@@ -0,0 +1,293 @@
+/*---------------------------------------------------------------------------*\
+  =========                 |
+  \\      /  F ield         | OpenFOAM: The Open Source CFD Toolbox
+   \\    /   O peration     |
+    \\  /    A nd           | www.openfoam.com
+     \\/     M anipulation  |
+-------------------------------------------------------------------------------
+    Copyright (C) 2024 OpenCFD Ltd.
+-------------------------------------------------------------------------------
+License
+    This file is part of OpenFOAM.
+
+    OpenFOAM is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OpenFOAM is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with OpenFOAM.  If not, see <http://www.gnu.org/licenses/>.
+
+Application
+    Test-floatCodec
+
+Description
+    Round-trip of binary lists with the floatCodec encoding.
+    The lossless encoding must reproduce the values bit-for-bit, the
+    lossy encoding must stay within half the tolerance and must never
+    be applied to mesh data or regular (restart) output.
+
+\*---------------------------------------------------------------------------*/
+
+#include "argList.H"
+#include "Time.H"
+#include "IOField.H"
+#include "polyMesh.H"
+#include "OCharStream.H"
+#include "ISpanStream.H"
+#include "Random.H"
+#include "floatCodec.H"
+
+#include <cstring>
+#include <limits>
+
+using namespace Foam;
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+label nFailed = 0;
+
+void report(const std::string& what, const bool ok)
+{
+    Info<< "    " << what.c_str() << ": " << (ok ? "ok" : "FAILED") << nl;
+
+    if (!ok)
+    {
+        ++nFailed;
+    }
+}
+
+
+// Bitwise comparison (NaN compares equal to itself)
+template<class Type>
+bool identical(const UList<Type>& a, const UList<Type>& b)
+{
+    return
+    (
+        a.size() == b.size()
+     && (a.empty() || !std::memcmp(a.cdata(), b.cdata(), a.size_bytes()))
+    );
+}
+
+
+// Largest absolute component difference
+template<class Type>
+scalar maxError(const UList<Type>& a, const UList<Type>& b)
+{
+    scalar err = 0;
+
+    forAll(a, i)
+    {
+        for (direction d = 0; d < pTraits<Type>::nComponents; ++d)
+        {
+            err = max
+            (
+                err,
+                mag
+                (
+                    component(a[i], d) - component(b[i], d)
+                )
+            );
+        }
+    }
+
+    return err;
+}
+
+
+// Write binary list contents with the encoding and read them back
+template<class Type>
+List<Type> roundTrip(const UList<Type>& input, const scalar tol = 0)
+{
+    OCharStream os(IOstreamOption::BINARY);
+    os.floatCompression(true);
+    os.floatTolerance(tol);
+    os << input;
+
+    ISpanStream is(os.view(), IOstreamOption::BINARY);
+    is.floatCompression(true);
+
+    List<Type> result;
+    is >> result;
+
+    return result;
+}
+
+
+// Random, smooth and special values
+List<scalar> sampleValues(const label n, Random& rndGen)
+{
+    List<scalar> values(n);
+
+    forAll(values, i)
+    {
+        switch (i % 3)
+        {
+            case 0:
+                values[i] = rndGen.GaussNormal<scalar>();
+                break;
+            case 1:
+                values[i] = 300 + std::sin(0.01*i);
+                break;
+            default:
+                values[i] = 1e5*rndGen.sample01<scalar>();
+                break;
+        }
+    }
+
+    const scalar special[] =
+    {
+        0, -0.0, 1,
+        std::numeric_limits<scalar>::denorm_min(),
+        std::numeric_limits<scalar>::min(),
+        std::numeric_limits<scalar>::max(),
+        -std::numeric_limits<scalar>::infinity(),
+        std::numeric_limits<scalar>::quiet_NaN()
+    };
+
+    label i = 0;
+    for (const scalar val : special)
+    {
+        if (i < n)
+        {
+            values[i] = val;
+        }
+        i += 7;
+    }
+
+    return values;
+}
+
+
+// The header written for the object
+std::string header(const IOobject& io)
+{
+    OCharStream os(IOstreamOption::BINARY);
+    io.writeHeader(os, IOField<scalar>::typeName);
+
+    return std::string(os.view());
+}
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+int main(int argc, char *argv[])
+{
+    argList::noParallel();
+    argList::noFunctionObjects();
+
+    #include "setRootCase.H"
+    #include "createTime.H"
+
+    Random rndGen(1234);
+
+    Info<< nl << "Lossless encoding" << nl;
+
+    for (const label n : { 0, 10, 63, 64, 1000, 100000 })
+    {
+        const List<scalar> scalars(sampleValues(n, rndGen));
+
+        List<vector> vectors(n);
+        forAll(vectors, i)
+        {
+            vectors[i] = vector(scalars[i], 2*scalars[i], -1e-3*i);
+        }
+
+        report
+        (
+            "scalar n=" + std::to_string(n),
+            identical(scalars, roundTrip(scalars))
+        );
+        report
+        (
+            "vector n=" + std::to_string(n),
+            identical(vectors, roundTrip(vectors))
+        );
+    }
+
+
+    Info<< nl << "Lossy encoding" << nl;
+
+    for (const scalar tol : { 1e-6, 1e-3, 0.1 })
+    {
+        List<scalar> scalars(10000);
+        forAll(scalars, i)
+        {
+            scalars[i] = 300 + 10*std::sin(0.001*i) + rndGen.sample01<scalar>();
+        }
+
+        report
+        (
+            "tolerance " + std::to_string(tol),
+            maxError(scalars, roundTrip(scalars, tol)) <= 0.5*tol
+        );
+    }
+
+
+    Info<< nl << "Tolerance selection" << nl;
+
+    {
+        const IOobject fieldIO("T", runTime.timeName(), runTime);
+
+        const IOobject pointsIO
+        (
+            "points",
+            runTime.timeName(),
+            polyMesh::meshSubDir,
+            runTime
+        );
+
+        const int oldLevel = floatCodec::level;
+        floatCodec::level = 1;
+
+        report("no tolerance", floatCodec::tolerance(fieldIO) == 0);
+        {
+            const floatCodec::toleranceScope lossy(1e-3);
+
+            report
+            (
+                "post-processing output",
+                floatCodec::tolerance(fieldIO) == 1e-3
+             && header(fieldIO).find("codecTolerance") != std::string::npos
+            );
+            report
+            (
+                "mesh data",
+                floatCodec::tolerance(pointsIO) == 0
+             && header(pointsIO).find("codecTolerance") == std::string::npos
+            );
+
+            // A regular write at a separate time
+            runTime.setTime(1000.5, 1);
+            runTime.writeNow();
+            report
+            (
+                "regular output",
+                floatCodec::tolerance(fieldIO) == 0
+             && header(fieldIO).find("codecTolerance") == std::string::npos
+            );
+            rmDir(runTime.timePath());
+        }
+        report("restored tolerance", floatCodec::tolerance(fieldIO) == 0);
+
+        floatCodec::level = oldLevel;
+    }
+
+    if (nFailed)
+    {
+        FatalErrorInFunction
+            << nFailed << " failed tests" << exit(FatalError);
+    }
+
+    Info<< nl << "End" << nl << endl;
+
+    return 0;
+}
+
+
+// ************************************************************************* //
@@ -0,0 +1,462 @@
+/*---------------------------------------------------------------------------*\
+  =========                 |
+  \\      /  F ield         | OpenFOAM: The Open Source CFD Toolbox
+   \\    /   O peration     |
+    \\  /    A nd           | www.openfoam.com
+     \\/     M anipulation  |
+-------------------------------------------------------------------------------
+    Copyright (C) 2024 OpenCFD Ltd.
+-------------------------------------------------------------------------------
+License
+    This file is part of OpenFOAM.
+
+    OpenFOAM is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OpenFOAM is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with OpenFOAM.  If not, see <http://www.gnu.org/licenses/>.
+
+Application
+    Test-fvMeshDistribute
+
+Description
+    Compare fvMeshDistribute in a single exchange round
+    (fvMeshDistribute.maxBufferSize 0) with a small maxBufferSize, which
+    sends the domains in pieces over several rounds and merges the
+    received parts after every round.
+
+    The same mesh, with cell, face and point fields, is read and
+    distributed twice with the same distribution. For each run the cell,
+    face (including flips) and point maps are checked against the mapped
+    fields and the distributed mesh. The two runs are compared per cell,
+    face and point of origin, since the order of the cells (and with it
+    the face orientation) depends on the order the parts are merged in.
+
+    Run in parallel on a decomposed case.
+
+\*---------------------------------------------------------------------------*/
+
+#include "argList.H"
+#include "Time.H"
+#include "fvMesh.H"
+#include "volFields.H"
+#include "surfaceFields.H"
+#include "fvMeshDistribute.H"
+#include "mapDistributePolyMesh.H"
+#include "globalIndex.H"
+#include "syncTools.H"
+#include "flipOp.H"
+
+using namespace Foam;
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+label nFailed = 0;
+
+template<class Type>
+bool identical(const UList<Type>& a, const UList<Type>& b)
+{
+    return
+    (
+        a.size() == b.size()
+     && std::equal(a.cbegin(), a.cend(), b.cbegin())
+    );
+}
+
+
+// Report if identical on all processors
+void report(const word& what, const bool localOk)
+{
+    const bool ok = returnReduceAnd(localOk);
+
+    Info<< "    " << what << ": "
+        << (ok ? "identical" : "DIFFERENT") << nl;
+
+    if (!ok)
+    {
+        ++nFailed;
+    }
+}
+
+
+template<class Type>
+void report(const word& what, const UList<Type>& a, const UList<Type>& b)
+{
+    report(what, identical(a, b));
+}
+
+
+// Per cell, face and point of origin (in a canonical order) the
+// distributed mesh and fields
+struct distributed
+{
+    labelList cellOrigin;
+    scalarField cellIds;
+    vectorField cellCentres;
+
+    // Internal faces: the (global) cells on both sides, with the flux
+    // from the lower to the higher cell
+    List<labelPair> faceCells;
+    scalarField faceFlux;
+
+    // Boundary faces per patch: the face of origin and the flux
+    wordList patchNames;
+    labelListList patchFaceOrigin;
+    List<scalarField> patchFlux;
+
+    pointField points;
+};
+
+
+// Flux from the owner to the neighbour cell id. Antisymmetric, hence the
+// same value from both sides of a coupled face
+scalarField faceFlux(const polyMesh& mesh, const scalarField& cellIds)
+{
+    const labelList& own = mesh.faceOwner();
+    const labelList& nei = mesh.faceNeighbour();
+    const polyBoundaryMesh& pbm = mesh.boundaryMesh();
+
+    const scalarField nbrIds
+    (
+        syncTools::swapBoundaryCellList(mesh, cellIds)
+    );
+
+    scalarField flux(mesh.nFaces());
+
+    forAll(nei, facei)
+    {
+        flux[facei] = cellIds[own[facei]] - cellIds[nei[facei]];
+    }
+
+    for (const polyPatch& pp : pbm)
+    {
+        forAll(pp, i)
+        {
+            const label facei = pp.start() + i;
+            const label bFacei = facei - mesh.nInternalFaces();
+
+            flux[facei] =
+            (
+                pp.coupled()
+              ? cellIds[own[facei]] - nbrIds[bFacei]
+              : cellIds[own[facei]]
+            );
+        }
+    }
+
+    return flux;
+}
+
+
+// Points in lexicographic order
+pointField sortedPoints(const pointField& points)
+{
+    labelList order(identity(points.size()));
+
+    std::sort
+    (
+        order.begin(),
+        order.end(),
+        [&](const label a, const label b)
+        {
+            const point& pa = points[a];
+            const point& pb = points[b];
+
+            return
+            (
+                pa.x() < pb.x()
+             || (pa.x() == pb.x() && pa.y() < pb.y())
+             || (pa.x() == pb.x() && pa.y() == pb.y() && pa.z() < pb.z())
+            );
+        }
+    );
+
+    return pointField(points, order);
+}
+
+
+// Read and distribute the mesh with the given maxBufferSize
+distributed distributeMesh(Time& runTime, const float bufferSize)
+{
+    Info<< nl << "Distribute with maxBufferSize " << bufferSize << nl;
+
+    fvMeshDistribute::maxBufferSize = bufferSize;
+
+    fvMesh mesh
+    (
+        IOobject
+        (
+            polyMesh::defaultRegion,
+            runTime.timeName(),
+            runTime,
+            IOobject::MUST_READ
+        )
+    );
+
+    // The original cells, faces (signed for the flip) and points
+    const globalIndex globalCells(mesh.nCells());
+    const globalIndex globalFaces(mesh.nFaces());
+
+    labelList cellOrigin(identity(mesh.nCells(), globalCells.localStart()));
+    labelList faceOrigin
+    (
+        identity(mesh.nFaces(), globalFaces.localStart() + 1)
+    );
+    vectorField oldCentres(mesh.cellCentres());
+    pointField oldPoints(mesh.points());
+
+    scalarField oldIds(cellOrigin.size());
+    forAll(cellOrigin, celli)
+    {
+        oldIds[celli] = cellOrigin[celli];
+    }
+    scalarField oldFlux(faceFlux(mesh, oldIds));
+
+    // The fields to distribute
+    volScalarField cellIds
+    (
+        IOobject
+        (
+            "cellIds",
+            runTime.timeName(),
+            mesh,
+            IOobject::NO_READ,
+            IOobject::NO_WRITE,
+            IOobject::REGISTER
+        ),
+        mesh,
+        dimensionedScalar(dimless, Zero)
+    );
+    cellIds.primitiveFieldRef() = oldIds;
+
+    volVectorField centres
+    (
+        IOobject
+        (
+            "centres",
+            runTime.timeName(),
+            mesh,
+            IOobject::NO_READ,
+            IOobject::NO_WRITE,
+            IOobject::REGISTER
+        ),
+        mesh,
+        dimensionedVector(dimLength, Zero)
+    );
+    centres.primitiveFieldRef() = oldCentres;
+
+    surfaceScalarField flux
+    (
+        IOobject
+        (
+            "flux",
+            runTime.timeName(),
+            mesh,
+            IOobject::NO_READ,
+            IOobject::NO_WRITE,
+            IOobject::REGISTER
+        ),
+        mesh,
+        dimensionedScalar(dimless, Zero)
+    );
+    flux.primitiveFieldRef() =
+        SubField<scalar>(oldFlux, mesh.nInternalFaces());
+    forAll(flux.boundaryField(), patchi)
+    {
+        flux.boundaryFieldRef()[patchi] =
+            mesh.boundaryMesh()[patchi].patchSlice(oldFlux);
+    }
+
+    // Send all cells away, spread over all processors
+    labelList distribution(mesh.nCells());
+    forAll(distribution, celli)
+    {
+        distribution[celli] =
+        (
+            UPstream::myProcNo() + 1
+          + (celli*UPstream::nProcs())/mesh.nCells()
+        ) % UPstream::nProcs();
+    }
+
+    fvMeshDistribute distributor(mesh);
+    autoPtr<mapDistributePolyMesh> map = distributor.distribute(distribution);
+
+    map().distributeCellData(cellOrigin);
+    map().distributeCellData(oldCentres);
+    map().faceMap().distribute(faceOrigin, flipLabelOp());
+    map().faceMap().distribute(oldFlux, flipOp());
+    map().distributePointData(oldPoints);
+
+    Info<< "    cells: " << returnReduce(mesh.nCells(), sumOp<label>())
+        << ", faces: " << returnReduce(mesh.nFaces(), sumOp<label>())
+        << ", points: " << returnReduce(mesh.nPoints(), sumOp<label>())
+        << nl;
+
+
+    // The maps against the mapped fields and the distributed mesh
+
+    scalarField mappedIds(cellOrigin.size());
+    forAll(cellOrigin, celli)
+    {
+        mappedIds[celli] = cellOrigin[celli];
+    }
+
+    report("cell map (ids)", mappedIds, cellIds.primitiveField());
+    report("cell map (centres)", oldCentres, centres.primitiveField());
+    report
+    (
+        "face map (flux)",
+        SubList<scalar>(oldFlux, mesh.nInternalFaces()),
+        flux.primitiveField()
+    );
+    report("face flips", oldFlux, faceFlux(mesh, mappedIds));
+    report("point map", oldPoints, mesh.points());
+
+
+    // Canonical order: per cell and face of origin
+
+    distributed result;
+    {
+        const labelList order(sortedOrder(cellOrigin));
+
+        result.cellOrigin = labelList(cellOrigin, order);
+        result.cellIds = scalarField(cellIds.primitiveField(), order);
+        result.cellCentres = vectorField(centres.primitiveField(), order);
+    }
+
+    {
+        const labelList& own = mesh.faceOwner();
+        const labelList& nei = mesh.faceNeighbour();
+
+        List<labelPair> faceCells(mesh.nInternalFaces());
+        scalarField lowerFlux(mesh.nInternalFaces());
+
+        forAll(nei, facei)
+        {
+            const label a = cellOrigin[own[facei]];
+            const label b = cellOrigin[nei[facei]];
+
+            faceCells[facei] = labelPair(min(a, b), max(a, b));
+            lowerFlux[facei] = (a < b ? 1 : -1)*flux[facei];
+        }
+
+        const labelList order(sortedOrder(faceCells));
+
+        result.faceCells = List<labelPair>(faceCells, order);
+        result.faceFlux = scalarField(lowerFlux, order);
+    }
+
+    const polyBoundaryMesh& pbm = mesh.boundaryMesh();
+
+    result.patchNames = pbm.names();
+    result.patchFaceOrigin.resize(pbm.size());
+    result.patchFlux.resize(pbm.size());
+
+    forAll(pbm, patchi)
+    {
+        labelList origin(pbm[patchi].patchSlice(faceOrigin));
+        for (label& facei : origin)
+        {
+            facei = mag(facei) - 1;
+        }
+
+        const labelList order(sortedOrder(origin));
+
+        result.patchFaceOrigin[patchi] = labelList(origin, order);
+        result.patchFlux[patchi] =
+            scalarField(flux.boundaryField()[patchi], order);
+    }
+
+    result.points = sortedPoints(mesh.points());
+
+    return result;
+}
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+int main(int argc, char *argv[])
+{
+    argList::noFunctionObjects();
+
+    argList::addOption
+    (
+        "maxBufferSize",
+        "bytes",
+        "The small buffer size to compare with (default: 10000)"
+    );
+
+    #include "setRootCase.H"
+    #include "createTime.H"
+
+    if (!UPstream::parRun())
+    {
+        FatalErrorInFunction
+            << "Needs to be run in parallel" << exit(FatalError);
+    }
+
+    const float smallSize = args.getOrDefault<float>("maxBufferSize", 10000);
+
+    const distributed single(distributeMesh(runTime, 0));
+    const distributed rounds(distributeMesh(runTime, smallSize));
+
+    Info<< nl << "Compare maxBufferSize 0 and " << smallSize << nl;
+
+    report("cells", single.cellOrigin, rounds.cellOrigin);
+    report("cell ids", single.cellIds, rounds.cellIds);
+    report("cell centres", single.cellCentres, rounds.cellCentres);
+    report("internal faces", single.faceCells, rounds.faceCells);
+    report("internal face flux", single.faceFlux, rounds.faceFlux);
+    report("patches", single.patchNames, rounds.patchNames);
+
+    // The patches differ per processor: report over all patches
+    bool facesOk = (single.patchNames == rounds.patchNames);
+    bool fluxOk = facesOk;
+
+    if (facesOk)
+    {
+        forAll(single.patchNames, patchi)
+        {
+            facesOk =
+            (
+                identical
+                (
+                    single.patchFaceOrigin[patchi],
+                    rounds.patchFaceOrigin[patchi]
+                )
+             && facesOk
+            );
+            fluxOk =
+            (
+                identical(single.patchFlux[patchi], rounds.patchFlux[patchi])
+             && fluxOk
+            );
+        }
+    }
+
+    report("patch faces", facesOk);
+    report("patch face flux", fluxOk);
+    report("points", single.points, rounds.points);
+
+    Info<< nl;
+
+    if (nFailed)
+    {
+        FatalErrorInFunction
+            << nFailed << " differences" << exit(FatalError);
+    }
+
+    Info<< "End" << nl << endl;
+
+    return 0;
+}
+
+
+// ************************************************************************* //
@@ -0,0 +1,181 @@
+/*---------------------------------------------------------------------------*\
+  =========                 |
+  \\      /  F ield         | OpenFOAM: The Open Source CFD Toolbox
+   \\    /   O peration     |
+    \\  /    A nd           | www.openfoam.com
+     \\/     M anipulation  |
+-------------------------------------------------------------------------------
+    Copyright (C) 2024 OpenCFD Ltd.
+-------------------------------------------------------------------------------
+License
+    This file is part of OpenFOAM.
+
+    OpenFOAM is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OpenFOAM is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with OpenFOAM.  If not, see <http://www.gnu.org/licenses/>.
+
+Application
+    Test-mpiCollatedFileOperation
+
+Description
+    Compare the mpiCollated output with the collated output, byte for byte,
+    and read it back with the mpiCollated handler.
+    Run in parallel on a decomposed case. One of the ranks has no data to
+    write or read (writeOnProc/readOnProc false).
+
+\*---------------------------------------------------------------------------*/
+
+#include "argList.H"
+#include "IOField.H"
+#include "IFstream.H"
+#include "primitiveFields.H"
+#include "Time.H"
+
+using namespace Foam;
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+// The local test size. Rank 1 has no data.
+label testSize(const label n)
+{
+    return (UPstream::myProcNo() == 1 ? 0 : n*(UPstream::myProcNo() + 1));
+}
+
+
+// The file contents (on master) written with the given handler
+DynamicList<char> writeWith
+(
+    const word& handlerType,
+    const IOobject& io,
+    const label n,
+    IOstreamOption streamOpt
+)
+{
+    fileHandler(fileOperation::New(handlerType, true));
+
+    const label sz = testSize(n);
+
+    IOField<scalar> fld(io, sz);
+    forAll(fld, i)
+    {
+        fld[i] = i + 1000*UPstream::myProcNo();
+    }
+
+    fld.writeObject(streamOpt, sz > 0);
+    fileHandler().flush();
+
+    DynamicList<char> contents;
+
+    if (UPstream::master())
+    {
+        const fileName fName(fileHandler().filePath(io.objectPath()));
+
+        Info<< "    " << handlerType << " : " << fName << nl;
+
+        contents = IFstream::readContents(fName);
+    }
+
+    return contents;
+}
+
+
+// Compare collated and mpiCollated output
+label compareOutput(const IOobject& io, const label n, IOstreamOption opt)
+{
+    Info<< "Size " << n << ", " << opt.format() << nl;
+
+    const DynamicList<char> collated(writeWith("collated", io, n, opt));
+    const DynamicList<char> mpiCollated(writeWith("mpiCollated", io, n, opt));
+
+    label nErrors = 0;
+
+    if (UPstream::master() && collated != mpiCollated)
+    {
+        Info<< "    mismatch: " << collated.size() << " and "
+            << mpiCollated.size() << " bytes" << nl;
+        ++nErrors;
+    }
+
+    // Read back with the mpiCollated handler
+    const label sz = testSize(n);
+
+    IOobject readIO(io);
+    readIO.readOpt(IOobject::MUST_READ);
+
+    const IOField<scalar> fld(readIO, sz > 0);
+
+    bool ok = (fld.size() == sz);
+    for (label i = 0; ok && i < sz; ++i)
+    {
+        ok = (fld[i] == scalar(i + 1000*UPstream::myProcNo()));
+    }
+
+    if (!returnReduceAnd(ok))
+    {
+        Info<< "    read back failed" << nl;
+        ++nErrors;
+    }
+
+    return nErrors;
+}
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+// Main program:
+
+int main(int argc, char *argv[])
+{
+    argList::noBanner();
+    argList::noFunctionObjects();
+
+    #include "setRootCase.H"
+    #include "createTime.H"
+
+    if (!UPstream::parRun())
+    {
+        Info<< "Requires a parallel run on a decomposed case" << nl;
+        return 0;
+    }
+
+    const IOobject io
+    (
+        "mpiCollatedTest",
+        runTime.timeName(),
+        runTime,
+        IOobject::NO_READ,
+        IOobject::NO_WRITE,
+        IOobject::NO_REGISTER
+    );
+
+    label nErrors = 0;
+
+    for (const label n : { 0, 10, 10000 })
+    {
+        nErrors += compareOutput(io, n, IOstreamOption::ASCII);
+        nErrors += compareOutput(io, n, IOstreamOption::BINARY);
+    }
+
+    fileHandler().rm(fileHandler().filePath(io.objectPath()));
+
+    if (nErrors)
+    {
+        FatalErrorInFunction
+            << nErrors << " failures" << nl
+            << exit(FatalError);
+    }
+
+    Info<< "\nEnd\n" << endl;
+    return 0;
+}
+
+
+// ************************************************************************* //
@@ -0,0 +1,132 @@
+/*---------------------------------------------------------------------------*\
+  =========                 |
+  \\      /  F ield         | OpenFOAM: The Open Source CFD Toolbox
+   \\    /   O peration     |
+    \\  /    A nd           | www.openfoam.com
+     \\/     M anipulation  |
+-------------------------------------------------------------------------------
+    Copyright (C) 2024 OpenCFD Ltd.
+-------------------------------------------------------------------------------
+License
+    This file is part of OpenFOAM.
+
+    OpenFOAM is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OpenFOAM is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with OpenFOAM.  If not, see <http://www.gnu.org/licenses/>.
+
+Application
+    Test-parallelFor
+
+Description
+    Compare thread-parallel and serial matrix assembly/manipulation.
+    The results are expected to be bit-identical.
+
+\*---------------------------------------------------------------------------*/
+
+#include "fvCFD.H"
+#include "parallelFor.H"
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+template<class Type>
+bool identical(const UList<Type>& a, const UList<Type>& b)
+{
+    return
+    (
+        a.size() == b.size()
+     && std::equal(a.cbegin(), a.cend(), b.cbegin())
+    );
+}
+
+
+template<class Type>
+void report(const word& what, const UList<Type>& a, const UList<Type>& b)
+{
+    Info<< "    " << what << ": "
+        << (identical(a, b) ? "identical" : "DIFFERENT") << nl;
+}
+
+
+// Assemble and manipulate a matrix with the current parallelFor settings
+tmp<fvScalarMatrix> assemble
+(
+    const volScalarField& T,
+    const surfaceScalarField& phi
+)
+{
+    const dimensionedScalar nu("nu", dimViscosity, 0.01);
+
+    tmp<fvScalarMatrix> tEqn
+    (
+        fvm::div(phi, T) - fvm::laplacian(nu, T)
+    );
+    tEqn.ref().relax(0.7);
+
+    return tEqn;
+}
+
+
+int main(int argc, char *argv[])
+{
+    argList::noFunctionObjects();
+
+    #include "setRootCase.H"
+    #include "createTime.H"
+    #include "createMesh.H"
+
+    Info<< "Threads supported: " << parallelFor::supported()
+        << ", available: " << parallelFor::nThreads() << nl << endl;
+
+    volScalarField T
+    (
+        IOobject("T", runTime.timeName(), mesh),
+        mag(mesh.C() - gAverage(mesh.C()))/dimensionedScalar(dimLength, 1),
+        fvPatchFieldBase::zeroGradientType()
+    );
+
+    surfaceScalarField phi
+    (
+        IOobject("phi", runTime.timeName(), mesh),
+        mesh.Sf() & dimensionedVector(dimVelocity, vector(1, 0.5, 0.25))
+    );
+
+    const int oldMinSize = parallelFor::minSize;
+
+    // Serial
+    parallelFor::minSize = std::numeric_limits<int>::max();
+    tmp<fvScalarMatrix> tserial = assemble(T, phi);
+    const scalarField serialH(tserial().H()().primitiveField());
+    const scalarField serialH1(tserial().H1()().primitiveField());
+
+    // Threaded (if supported)
+    parallelFor::minSize = 0;
+    tmp<fvScalarMatrix> tthreaded = assemble(T, phi);
+    const scalarField threadedH(tthreaded().H()().primitiveField());
+    const scalarField threadedH1(tthreaded().H1()().primitiveField());
+
+    parallelFor::minSize = oldMinSize;
+
+    Info<< "Serial vs threaded" << nl;
+    report("diag", tserial().diag(), tthreaded().diag());
+    report("lower", tserial().lower(), tthreaded().lower());
+    report("upper", tserial().upper(), tthreaded().upper());
+    report("source", tserial().source(), tthreaded().source());
+    report("H", serialH, threadedH);
+    report("H1", serialH1, threadedH1);
+
+    Info<< "\nEnd\n" << endl;
+
+    return 0;
+}
+
+
+// ************************************************************************* //
@@ -0,0 +1,224 @@
+/*---------------------------------------------------------------------------*\
+  =========                 |
+  \\      /  F ield         | OpenFOAM: The Open Source CFD Toolbox
+   \\    /   O peration     |
+    \\  /    A nd           | www.openfoam.com
+     \\/     M anipulation  |
+-------------------------------------------------------------------------------
+    Copyright (C) 2024 OpenCFD Ltd.
+-------------------------------------------------------------------------------
+License
+    This file is part of OpenFOAM.
+
+    OpenFOAM is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OpenFOAM is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with OpenFOAM.  If not, see <http://www.gnu.org/licenses/>.
+
+Application
+    Test-pgzstream
+
+Description
+    Round-trip of the block-parallel gzip output stream (opgzstream).
+    Data shorter than one block, an exact multiple of the block size and
+    several blocks with a partial last block are written compressed with
+    gzipThreads > 0, in a single write and in pieces, read back through
+    IFstream (igzstream) and compared byte by byte.
+
+\*---------------------------------------------------------------------------*/
+
+#include "argList.H"
+#include "IFstream.H"
+#include "OFstream.H"
+#include "OSspecific.H"
+#include "pgzstream.H"
+
+#include <algorithm>
+#include <cstdio>
+#include <iterator>
+
+using namespace Foam;
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+label nFailed = 0;
+
+// Field-like ASCII data, compressible but not trivially so
+std::string makeData(const size_t len)
+{
+    std::string data;
+    data.reserve(len + 64);
+
+    unsigned long seed = 12345;
+    char line[64];
+
+    while (data.size() < len)
+    {
+        seed = (1103515245*seed + 12345) % 2147483648ul;
+
+        const int n = std::snprintf
+        (
+            line,
+            sizeof(line),
+            "(%lu %g 0)\n",
+            seed % 1000,
+            double(seed)/2147483648.0
+        );
+
+        data.append(line, n);
+    }
+
+    data.resize(len);
+
+    return data;
+}
+
+
+void roundTrip
+(
+    const std::string& name,
+    const std::string& data,
+    const size_t pieceSize,
+    const IOstreamOption::atomicType atomic
+)
+{
+    const fileName file("Test-pgzstream-" + name);
+
+    {
+        OFstream os
+        (
+            atomic,
+            file,
+            IOstreamOption(IOstreamOption::ASCII, IOstreamOption::COMPRESSED)
+        );
+
+        if (!dynamic_cast<const opgzstream*>(&os.stdStream()))
+        {
+            Info<< "    " << name << ": not written with opgzstream" << nl;
+            ++nFailed;
+            return;
+        }
+
+        for (size_t pos = 0; pos < data.size(); pos += pieceSize)
+        {
+            os.stdStream().write
+            (
+                data.data() + pos,
+                std::min(pieceSize, data.size() - pos)
+            );
+        }
+    }
+
+    std::string result;
+    {
+        IFstream is(file);
+
+        if (is.good())
+        {
+            result.assign
+            (
+                std::istreambuf_iterator<char>(is.stdStream()),
+                std::istreambuf_iterator<char>()
+            );
+        }
+    }
+
+    const bool ok = (result == data);
+
+    Info<< "    " << name << ": " << data.size() << " bytes, "
+        << (ok ? "identical" : "DIFFERENT") << nl;
+
+    if (!ok)
+    {
+        ++nFailed;
+    }
+
+    Foam::rm(file + ".gz");
+}
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+//  Main program:
+
+int main(int argc, char *argv[])
+{
+    argList::noBanner();
+    argList::noParallel();
+
+    argList::addOption
+    (
+        "threads",
+        "N",
+        "Number of compression threads (default: 4)"
+    );
+
+    #include "setRootCase.H"
+
+    opgzstream::nThreads = args.getOrDefault<int>("threads", 4);
+
+    if (opgzstream::nThreads <= 0)
+    {
+        FatalErrorInFunction
+            << "Number of threads must be positive" << exit(FatalError);
+    }
+
+    const size_t blockSize = pgzstreambuf::blockSize;
+
+    const std::string shortData(makeData(1000));
+    const std::string exactData(makeData(4*blockSize));
+    const std::string longData(makeData(5*blockSize + 12345));
+
+    Info<< "gzipThreads " << opgzstream::nThreads
+        << ", block size " << label(blockSize) << nl;
+
+    for
+    (
+        const auto atomic
+      : { IOstreamOption::NON_ATOMIC, IOstreamOption::ATOMIC }
+    )
+    {
+        const std::string suffix
+        (
+            atomic == IOstreamOption::ATOMIC ? "-atomic" : ""
+        );
+
+        Info<< nl << "Single write"
+            << (atomic == IOstreamOption::ATOMIC ? " (atomic)" : "") << nl;
+
+        roundTrip("short" + suffix, shortData, shortData.size(), atomic);
+        roundTrip("exact" + suffix, exactData, exactData.size(), atomic);
+        roundTrip("long" + suffix, longData, longData.size(), atomic);
+
+        Info<< nl << "Written in pieces"
+            << (atomic == IOstreamOption::ATOMIC ? " (atomic)" : "") << nl;
+
+        // Pieces that fit exactly into a block and pieces that straddle
+        // the block boundaries
+        roundTrip("short-pieces" + suffix, shortData, 100, atomic);
+        roundTrip("exact-pieces" + suffix, exactData, 4096, atomic);
+        roundTrip("long-pieces" + suffix, longData, 1000, atomic);
+    }
+
+    Info<< nl;
+
+    if (nFailed)
+    {
+        FatalErrorInFunction
+            << nFailed << " differences" << exit(FatalError);
+    }
+
+    Info<< "End" << nl << endl;
+
+    return 0;
+}
+
+
+// ************************************************************************* //
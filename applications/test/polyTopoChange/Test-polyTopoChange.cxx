@@ -0,0 +1,353 @@
+/*---------------------------------------------------------------------------*\
+  =========                 |
+  \\      /  F ield         | OpenFOAM: The Open Source CFD Toolbox
+   \\    /   O peration     |
+    \\  /    A nd           | www.openfoam.com
+     \\/     M anipulation  |
+-------------------------------------------------------------------------------
+    Copyright (C) 2024 OpenCFD Ltd.
+-------------------------------------------------------------------------------
+License
+    This file is part of OpenFOAM.
+
+    OpenFOAM is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OpenFOAM is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with OpenFOAM.  If not, see <http://www.gnu.org/licenses/>.
+
+Application
+    Test-polyTopoChange
+
+Description
+    Compare thread-parallel and serial polyTopoChange::changeMesh.
+    The case mesh is refined once (hexRef8) to get split faces and hanging
+    points as from snappyHexMesh. On copies of the refined mesh, a further
+    refinement and a cell removal are made with parallelFor.minSize 0 and
+    serially, with and without cell ordering. The maps and the changed
+    meshes are expected to be identical.
+
+    Run on a hex or snappyHexMesh case.
+
+\*---------------------------------------------------------------------------*/
+
+#include "argList.H"
+#include "Time.H"
+#include "polyMesh.H"
+#include "parallelFor.H"
+#include "polyTopoChange.H"
+#include "mapPolyMesh.H"
+#include "hexRef8.H"
+#include "removeCells.H"
+
+using namespace Foam;
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+label nFailed = 0;
+
+template<class Type>
+bool identical(const UList<Type>& a, const UList<Type>& b)
+{
+    return
+    (
+        a.size() == b.size()
+     && std::equal(a.cbegin(), a.cend(), b.cbegin())
+    );
+}
+
+
+template<class Type>
+void report(const word& what, const UList<Type>& a, const UList<Type>& b)
+{
+    const bool ok = identical(a, b);
+
+    Info<< "    " << what << ": "
+        << (ok ? "identical" : "DIFFERENT") << nl;
+
+    if (!ok)
+    {
+        ++nFailed;
+    }
+}
+
+
+// Cells with centre component below the average
+labelList lowerCells(const polyMesh& mesh, const direction cmpt)
+{
+    const scalarField x(mesh.cellCentres().component(cmpt));
+    const scalar xMid = gAverage(x);
+
+    DynamicList<label> cells(x.size());
+    forAll(x, celli)
+    {
+        if (x[celli] < xMid)
+        {
+            cells.push_back(celli);
+        }
+    }
+    return labelList(std::move(cells));
+}
+
+
+// Copy of the mesh (points, faces, patches and zones)
+autoPtr<polyMesh> copyMesh(const word& name, const polyMesh& mesh)
+{
+    auto meshPtr = autoPtr<polyMesh>::New
+    (
+        IOobject
+        (
+            name,
+            mesh.facesInstance(),
+            mesh.time(),
+            IOobject::NO_READ,
+            IOobject::NO_WRITE
+        ),
+        pointField(mesh.points()),
+        faceList(mesh.faces()),
+        labelList(mesh.faceOwner()),
+        labelList(mesh.faceNeighbour())
+    );
+    polyMesh& newMesh = meshPtr();
+
+    const polyBoundaryMesh& pbm = mesh.boundaryMesh();
+    polyPatchList patches(pbm.size());
+    forAll(pbm, patchi)
+    {
+        patches.set(patchi, pbm[patchi].clone(newMesh.boundaryMesh()));
+    }
+    newMesh.addPatches(patches);
+
+    PtrList<pointZone> pz(mesh.pointZones().size());
+    forAll(pz, zonei)
+    {
+        pz.set(zonei, mesh.pointZones()[zonei].clone(newMesh.pointZones()));
+    }
+    PtrList<faceZone> fz(mesh.faceZones().size());
+    forAll(fz, zonei)
+    {
+        fz.set(zonei, mesh.faceZones()[zonei].clone(newMesh.faceZones()));
+    }
+    PtrList<cellZone> cz(mesh.cellZones().size());
+    forAll(cz, zonei)
+    {
+        cz.set(zonei, mesh.cellZones()[zonei].clone(newMesh.cellZones()));
+    }
+    newMesh.addZones(std::move(pz), std::move(fz), std::move(cz));
+
+    return meshPtr;
+}
+
+
+// Change a copy of the mesh with the current parallelFor settings
+template<class SetChanges>
+autoPtr<mapPolyMesh> changeMesh
+(
+    polyMesh& mesh,
+    const SetChanges& setChanges,
+    const bool orderCells
+)
+{
+    polyTopoChange meshMod(mesh);
+    setChanges(mesh, meshMod);
+
+    return meshMod.changeMesh
+    (
+        mesh,
+        false,          // no inflation
+        true,           // syncParallel
+        orderCells
+    );
+}
+
+
+// Compare the threaded and serial mesh change
+template<class SetChanges>
+void compare
+(
+    const word& what,
+    const polyMesh& mesh,
+    const SetChanges& setChanges
+)
+{
+    const int oldMinSize = parallelFor::minSize;
+
+    for (const bool orderCells : {false, true})
+    {
+        autoPtr<polyMesh> serialMesh = copyMesh("serial", mesh);
+        autoPtr<polyMesh> threadedMesh = copyMesh("threaded", mesh);
+
+        // Serial
+        parallelFor::minSize = std::numeric_limits<int>::max();
+        autoPtr<mapPolyMesh> serial =
+            changeMesh(serialMesh(), setChanges, orderCells);
+
+        // Threaded (if supported)
+        parallelFor::minSize = 0;
+        autoPtr<mapPolyMesh> threaded =
+            changeMesh(threadedMesh(), setChanges, orderCells);
+
+        parallelFor::minSize = oldMinSize;
+
+        Info<< what << " (orderCells:" << orderCells
+            << ") cells:" << mesh.nCells() << " -> " << serialMesh().nCells()
+            << nl << "Serial vs threaded" << nl;
+
+        report("pointMap", serial().pointMap(), threaded().pointMap());
+        report("faceMap", serial().faceMap(), threaded().faceMap());
+        report("cellMap", serial().cellMap(), threaded().cellMap());
+        report
+        (
+            "reversePointMap",
+            serial().reversePointMap(),
+            threaded().reversePointMap()
+        );
+        report
+        (
+            "reverseFaceMap",
+            serial().reverseFaceMap(),
+            threaded().reverseFaceMap()
+        );
+        report
+        (
+            "reverseCellMap",
+            serial().reverseCellMap(),
+            threaded().reverseCellMap()
+        );
+        report
+        (
+            "flipFaceFlux",
+            serial().flipFaceFlux().sortedToc(),
+            threaded().flipFaceFlux().sortedToc()
+        );
+        report("points", serialMesh().points(), threadedMesh().points());
+        report("owner", serialMesh().faceOwner(), threadedMesh().faceOwner());
+        report
+        (
+            "neighbour",
+            serialMesh().faceNeighbour(),
+            threadedMesh().faceNeighbour()
+        );
+        Info<< nl;
+    }
+}
+
+
+int main(int argc, char *argv[])
+{
+    argList::noFunctionObjects();
+
+    #include "setRootCase.H"
+    #include "createTime.H"
+    #include "createPolyMesh.H"
+
+    Info<< "Threads supported: " << parallelFor::supported()
+        << ", available: " << parallelFor::nThreads() << nl << endl;
+
+    // Refine the lower half in x (in place)
+    hexRef8 meshCutter(mesh);
+    {
+        const labelList cellsToRefine
+        (
+            meshCutter.consistentRefinement(lowerCells(mesh, 0), true)
+        );
+
+        polyTopoChange meshMod(mesh);
+        meshCutter.setRefinement(cellsToRefine, meshMod);
+
+        autoPtr<mapPolyMesh> map = meshMod.changeMesh(mesh, false);
+        mesh.updateMesh(map());
+        meshCutter.updateMesh(map());
+
+        Info<< "Refined " << returnReduce(cellsToRefine.size(), sumOp<label>())
+            << " cells" << nl << endl;
+    }
+
+
+    // Further refinement of the lower half in y: split faces of cells of
+    // different levels
+    {
+        const labelList cellsToRefine
+        (
+            meshCutter.consistentRefinement(lowerCells(mesh, 1), true)
+        );
+
+        compare
+        (
+            "refinement",
+            mesh,
+            [&](const polyMesh& copy, polyTopoChange& meshMod)
+            {
+                // Fresh refinement engine: setRefinement updates its state
+                hexRef8 cutter
+                (
+                    copy,
+                    meshCutter.cellLevel(),
+                    meshCutter.pointLevel(),
+                    meshCutter.level0EdgeLength()
+                );
+                cutter.setRefinement(cellsToRefine, meshMod);
+            }
+        );
+    }
+
+
+    // Removal of the lower half in z: retired cells, faces and points
+    {
+        const labelList cellsToRemove(lowerCells(mesh, 2));
+
+        // Exposed faces into the first non-coupled patch
+        label patchi = 0;
+        while
+        (
+            patchi < mesh.boundaryMesh().size()
+         && mesh.boundaryMesh()[patchi].coupled()
+        )
+        {
+            ++patchi;
+        }
+
+        compare
+        (
+            "removal",
+            mesh,
+            [&](const polyMesh& copy, polyTopoChange& meshMod)
+            {
+                removeCells cellRemover(copy);
+                const labelList exposedFaces
+                (
+                    cellRemover.getExposedFaces(cellsToRemove)
+                );
+                const labelList exposedPatchIDs(exposedFaces.size(), patchi);
+
+                cellRemover.setRefinement
+                (
+                    cellsToRemove,
+                    exposedFaces,
+                    exposedPatchIDs,
+                    meshMod
+                );
+            }
+        );
+    }
+
+    if (nFailed)
+    {
+        FatalErrorInFunction
+            << nFailed << " differences" << exit(FatalError);
+    }
+
+    Info<< "End" << nl << endl;
+
+    return 0;
+}
+
+
+// ************************************************************************* //
@@ -0,0 +1,220 @@
+/*---------------------------------------------------------------------------*\
+  =========                 |
+  \\      /  F ield         | OpenFOAM: The Open Source CFD Toolbox
+   \\    /   O peration     |
+    \\  /    A nd           | www.openfoam.com
+     \\/     M anipulation  |
+-------------------------------------------------------------------------------
+    Copyright (C) 2024 OpenCFD Ltd.
+-------------------------------------------------------------------------------
+License
+    This file is part of OpenFOAM.
+
+    OpenFOAM is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OpenFOAM is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with OpenFOAM.  If not, see <http://www.gnu.org/licenses/>.
+
+Application
+    Test-renumberBenchmark
+
+Description
+    Compare renumbering methods on a mesh: matrix bandwidth and profile
+    and the time of a matrix-vector product (lduMatrix::Amul) with the
+    renumbered addressing. The mesh itself is not modified.
+
+    Usage
+    \code
+    Test-renumberBenchmark -methods '(CuthillMcKee hilbert morton)'
+    \endcode
+
+\*---------------------------------------------------------------------------*/
+
+#include "argList.H"
+#include "Time.H"
+#include "polyMesh.H"
+#include "lduPrimitiveMesh.H"
+#include "lduMatrix.H"
+#include "renumberMethod.H"
+#include "clockTime.H"
+
+using namespace Foam;
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+int main(int argc, char *argv[])
+{
+    argList::addNote
+    (
+        "Compare matrix bandwidth and Amul time for renumbering methods"
+    );
+
+    argList::noParallel();
+    argList::noFunctionObjects();
+
+    argList::addOption
+    (
+        "methods",
+        "wordList",
+        "Renumbering methods"
+        " (default: none CuthillMcKee reverseCuthillMcKee hilbert morton)"
+    );
+    argList::addOption
+    (
+        "nIter",
+        "N",
+        "Number of matrix-vector products to time (default: 100)"
+    );
+
+    #include "setRootCase.H"
+    #include "createTime.H"
+    #include "createPolyMesh.H"
+
+    wordList methodNames
+    ({
+        "none", "CuthillMcKee", "reverseCuthillMcKee", "hilbert", "morton"
+    });
+    args.readListIfPresent<word>("methods", methodNames);
+
+    const label nIter = args.getOrDefault<label>("nIter", 100);
+
+    const label nCells = mesh.nCells();
+    const label nInternalFaces = mesh.nInternalFaces();
+    const labelList& own = mesh.faceOwner();
+    const labelList& nei = mesh.faceNeighbour();
+    const pointField& cellCentres = mesh.cellCentres();
+
+    Info<< "Mesh cells: " << nCells
+        << " internal faces: " << nInternalFaces << nl
+        << "Amul iterations: " << nIter << nl << nl
+        << "method  renumber-time  bandwidth  profile  Amul-time" << nl;
+
+    for (const word& methodName : methodNames)
+    {
+        dictionary methodDict;
+        methodDict.set("method", methodName);
+
+        autoPtr<renumberMethod> methodPtr = renumberMethod::New(methodDict);
+        const renumberMethod& method = methodPtr();
+
+        clockTime timing;
+
+        const labelList cellOrder
+        (
+            method.no_topology()
+          ? method.renumber(nCells)
+          : method.renumber(mesh)
+        );
+
+        const double renumberTime = timing.timeIncrement();
+
+        const labelList oldToNew(invert(nCells, cellOrder));
+
+
+        // Renumbered addressing in upper-triangular order
+
+        labelList lower(nInternalFaces);
+        labelList upper(nInternalFaces);
+
+        for (label facei = 0; facei < nInternalFaces; ++facei)
+        {
+            const label a = oldToNew[own[facei]];
+            const label b = oldToNew[nei[facei]];
+
+            lower[facei] = Foam::min(a, b);
+            upper[facei] = Foam::max(a, b);
+        }
+
+        {
+            const labelList faceOrder
+            (
+                lduPrimitiveMesh::upperTriOrder(nCells, lower, upper)
+            );
+
+            inplaceReorder(faceOrder, lower);
+            inplaceReorder(faceOrder, upper);
+        }
+
+
+        // Bandwidth and profile (sum of the row widths)
+
+        label bandwidth = 0;
+        scalar profile = 0;
+
+        forAll(lower, facei)
+        {
+            const label width = upper[facei] - lower[facei];
+
+            bandwidth = Foam::max(bandwidth, width);
+
+            // Faces of a row are sorted: the last one has the largest width
+            if (facei == lower.size()-1 || lower[facei+1] != lower[facei])
+            {
+                profile += scalar(width);
+            }
+        }
+
+
+        // Matrix-vector product
+
+        lduPrimitiveMesh lduMesh
+        (
+            nCells,
+            lower,
+            upper,
+            UPstream::worldComm,
+            true    // reuse (transfer) the addressing
+        );
+
+        lduMatrix matrix(lduMesh);
+        matrix.diag() = 6;
+        matrix.upper() = -1;
+
+        solveScalarField psi(nCells);
+        forAll(psi, celli)
+        {
+            psi[celli] = mag(cellCentres[cellOrder[celli]]);
+        }
+
+        solveScalarField Apsi(nCells);
+        const FieldField<Field, scalar> interfaceBouCoeffs;
+        const lduInterfaceFieldPtrsList interfaces;
+
+        timing.resetTimeIncrement();
+
+        for (label iter = 0; iter < nIter; ++iter)
+        {
+            matrix.Amul
+            (
+                Apsi,
+                tmp<solveScalarField>(psi),
+                interfaceBouCoeffs,
+                interfaces,
+                0
+            );
+        }
+
+        const double amulTime = timing.timeIncrement();
+
+        Info<< methodName
+            << "  " << renumberTime
+            << "  " << bandwidth
+            << "  " << profile
+            << "  " << amulTime/Foam::max(nIter, label(1)) << nl;
+    }
+
+    Info<< "\nEnd\n" << endl;
+
+    return 0;
+}
+
+
+// ************************************************************************* //
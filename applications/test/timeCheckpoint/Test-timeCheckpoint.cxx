@@ -0,0 +1,214 @@
+/*---------------------------------------------------------------------------*\
+  =========                 |
+  \\      /  F ield         | OpenFOAM: The Open Source CFD Toolbox
+   \\    /   O peration     |
+    \\  /    A nd           | www.openfoam.com
+     \\/     M anipulation  |
+-------------------------------------------------------------------------------
+    Copyright (C) 2024 OpenCFD Ltd.
+-------------------------------------------------------------------------------
+License
+    This file is part of OpenFOAM.
+
+    OpenFOAM is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OpenFOAM is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with OpenFOAM.  If not, see <http://www.gnu.org/licenses/>.
+
+Application
+    Test-timeCheckpoint
+
+Description
+    Write a field with old-time levels together with its checkpoint,
+    remove the regular output and restart from the checkpoint alone.
+    The restored values (including the old times) must be bit-identical.
+
+\*---------------------------------------------------------------------------*/
+
+#include "fvCFD.H"
+#include "Random.H"
+#include "timeCheckpoint.H"
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+template<class Type>
+bool identical(const UList<Type>& a, const UList<Type>& b)
+{
+    return
+    (
+        a.size() == b.size()
+     && std::equal(a.cbegin(), a.cend(), b.cbegin())
+    );
+}
+
+
+// The internal and boundary values of a field and its old times
+List<scalarField> values(const volScalarField& fld)
+{
+    List<scalarField> result;
+
+    const volScalarField* ptr = &fld;
+    for (label level = 0; level <= fld.nOldTimes(); ++level)
+    {
+        result.push_back(ptr->primitiveField());
+        for (const auto& pfld : ptr->boundaryField())
+        {
+            result.push_back(pfld);
+        }
+        if (level < fld.nOldTimes())
+        {
+            ptr = &(ptr->oldTime());
+        }
+    }
+
+    return result;
+}
+
+
+void randomise(volScalarField& fld, Random& rnd)
+{
+    for (scalar& val : fld.primitiveFieldRef())
+    {
+        val = rnd.sample01<scalar>();
+    }
+    for (auto& pfld : fld.boundaryFieldRef())
+    {
+        for (scalar& val : pfld)
+        {
+            val = rnd.sample01<scalar>();
+        }
+    }
+}
+
+
+// Write with checkpoint, restart from the checkpoint only
+bool roundTrip
+(
+    Time& runTime,
+    const fvMesh& mesh,
+    IOstreamOption::streamFormat fmt
+)
+{
+    const word fieldName("checkpointField");
+    const word timeName(runTime.timeName());
+
+    List<scalarField> written;
+    {
+        volScalarField fld
+        (
+            IOobject
+            (
+                fieldName,
+                timeName,
+                mesh,
+                IOobject::NO_READ,
+                IOobject::AUTO_WRITE
+            ),
+            mesh,
+            dimensionedScalar(dimless, Zero),
+            fvPatchFieldBase::calculatedType()
+        );
+
+        // Values not representable in ASCII with the default precision
+        Random rnd(1234);
+        randomise(fld, rnd);
+        randomise(fld.oldTime(), rnd);
+        randomise(fld.oldTime().oldTime(), rnd);
+
+        written = values(fld);
+
+        if (!timeCheckpoint::write(runTime, IOstreamOption(fmt)))
+        {
+            FatalErrorInFunction
+                << "Failed writing checkpoint for time " << timeName
+                << exit(FatalError);
+        }
+    }
+
+    // Only the checkpoint remains
+    Foam::rm(runTime.timePath()/fieldName);
+
+    timeCheckpoint::restore(runTime.path(), timeName);
+
+    bool same = false;
+    {
+        volScalarField fld
+        (
+            IOobject
+            (
+                fieldName,
+                timeName,
+                mesh,
+                IOobject::MUST_READ,
+                IOobject::NO_WRITE
+            ),
+            mesh
+        );
+
+        same = (fld.nOldTimes() == 2);
+        if (same)
+        {
+            const List<scalarField> restored(values(fld));
+
+            same = (restored.size() == written.size());
+            forAll(written, i)
+            {
+                same = same && identical(written[i], restored[i]);
+            }
+        }
+
+        Info<< "    nOldTimes: " << fld.nOldTimes() << nl;
+    }
+
+    timeCheckpoint::release();
+
+    Info<< "    " << IOstreamOption::formatNames[fmt] << ": "
+        << (same ? "identical" : "DIFFERENT") << nl;
+
+    Foam::rmDir(runTime.timePath());
+
+    return same;
+}
+
+
+int main(int argc, char *argv[])
+{
+    argList::noFunctionObjects();
+    argList::noParallel();
+
+    #include "setRootCase.H"
+    #include "createTime.H"
+    #include "createMesh.H"
+
+    bool ok = true;
+
+    runTime.setDeltaT(0.125);
+
+    for
+    (
+        const auto fmt
+      : { IOstreamOption::ASCII, IOstreamOption::BINARY }
+    )
+    {
+        // A time not present in the case
+        runTime.setTime(1000.125*(1 + fmt), 1 + fmt);
+
+        Info<< "Round-trip at time " << runTime.timeName() << nl;
+        ok = roundTrip(runTime, mesh, fmt) && ok;
+    }
+
+    Info<< nl << (ok ? "End" : "FAILED") << nl << endl;
+
+    return (ok ? 0 : 1);
+}
+
+
+// ************************************************************************* //